@@ -0,0 +1,218 @@
+#include "SolutionOptimizer.h"
+#include "Util.h"
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    constexpr char faceNames[6] = {'F', 'B', 'L', 'R', 'U', 'D'};
+
+    Face fromFaceName(char c)
+    {
+        for (int face = FRONT; face <= BOTTOM; face++)
+            if (faceNames[face] == c)
+                return Face(face);
+        return INVALID;
+    }
+
+    std::string cubeKey(const RubiksCube &cube)
+    {
+        const auto matrix = cube.toColorMatrix();
+        std::string key;
+        key.reserve(6 * 9);
+        for (int face = FRONT; face <= BOTTOM; face++)
+            for (int i = 0; i < 9; i++)
+                key.push_back(char(matrix[face][i]));
+        return key;
+    }
+
+    void applyMove(RubiksCube &cube, const Move &move)
+    {
+        if (move.turns == 3)
+            cube.rotate(move.face);
+        cube.rotate(move.face, move.turns >= 2);
+    }
+}
+
+bool operator==(const Move &lhs, const Move &rhs)
+{
+    return lhs.face == rhs.face && lhs.turns == rhs.turns;
+}
+
+std::ostream &operator<<(std::ostream &os, const Move &move)
+{
+    os << faceNames[move.face];
+    if (move.turns == 2)
+        os << '2';
+    else if (move.turns == 3)
+        os << '\'';
+    return os;
+}
+
+std::vector<Move> parseMoves(const std::string &moves)
+{
+    std::vector<Move> result;
+    for (size_t i = 0; i < moves.size(); i++)
+    {
+        if (isspace(moves[i]))
+            continue;
+        Face face = fromFaceName(moves[i]);
+        if (face == INVALID)
+            throw std::invalid_argument("Invalid move: " + moves.substr(i, 1));
+        int turns = 1;
+        if (i + 1 < moves.size() && moves[i + 1] == '2')
+            turns = 2, i++;
+        else if (i + 1 < moves.size() && moves[i + 1] == '\'')
+            turns = 3, i++;
+        result.push_back({face, turns});
+    }
+    return result;
+}
+
+std::string movesToString(const std::vector<Move> &moves)
+{
+    std::ostringstream ss;
+    for (size_t i = 0; i < moves.size(); i++)
+        ss << (i ? " " : "") << moves[i];
+    return ss.str();
+}
+
+void applyMoves(RubiksCube &cube, const std::vector<Move> &moves)
+{
+    for (const auto &move : moves)
+        applyMove(cube, move);
+}
+
+std::ostream &operator<<(std::ostream &os, const OptimizationReport &report)
+{
+    os << "Solution length: " << report.originalLength << " -> " << report.optimizedLength
+       << " (" << report.originalLength - report.optimizedLength << " moves saved in "
+       << report.passes << " passes)" << std::endl;
+    os << movesToString(report.solution);
+    return os;
+}
+
+SolutionOptimizer::SolutionOptimizer(int maxWindow, unsigned int numThreads) : maxWindow(maxWindow), numThreads(numThreads)
+{
+    if (maxWindow < 1)
+        throw std::invalid_argument("Window length has to be positive");
+    if (this->numThreads == 0)
+        this->numThreads = std::max(1u, std::thread::hardware_concurrency());
+    buildTable();
+}
+
+int SolutionOptimizer::getMaxWindow() const
+{
+    return maxWindow;
+}
+
+size_t SolutionOptimizer::tableSize() const
+{
+    return optimalSequences.size();
+}
+
+void SolutionOptimizer::buildTable()
+{
+    // Breadth first search from the solved cube, so the first sequence reaching a position is the shortest one
+    std::vector<std::pair<RubiksCube, std::vector<Move>>> frontier = {{RubiksCube(), {}}};
+    optimalSequences[cubeKey(frontier.back().first)] = {};
+    for (int depth = 0; depth < maxWindow; depth++)
+    {
+        std::vector<std::pair<RubiksCube, std::vector<Move>>> next;
+        for (const auto &[cube, sequence] : frontier)
+            for (int face = FRONT; face <= BOTTOM; face++)
+            {
+                // Turning the same face twice in a row is never optimal
+                if (!sequence.empty() && sequence.back().face == face)
+                    continue;
+                RubiksCube child(cube);
+                for (int turns = 1; turns <= 3; turns++)
+                {
+                    child.rotate(Face(face));
+                    auto [it, inserted] = optimalSequences.try_emplace(cubeKey(child), sequence);
+                    if (!inserted)
+                        continue;
+                    it->second.push_back({Face(face), turns});
+                    next.emplace_back(child, it->second);
+                }
+            }
+        frontier = std::move(next);
+        DEBUG("Optimal sequences of length " << depth + 1 << ": " << frontier.size());
+    }
+}
+
+const std::vector<Move> &SolutionOptimizer::optimalSequence(const std::vector<Move> &moves, size_t begin, size_t end) const
+{
+    assert(end - begin <= size_t(maxWindow));
+    RubiksCube cube;
+    for (size_t i = begin; i < end; i++)
+        applyMove(cube, moves[i]);
+    // Every position reachable with at most maxWindow moves is in the table
+    return optimalSequences.at(cubeKey(cube));
+}
+
+std::vector<Move> SolutionOptimizer::optimizePass(const std::vector<Move> &moves) const
+{
+    const size_t n = moves.size();
+    const size_t window = maxWindow;
+
+    // replacements[i][l - 1] is the shortest sequence equivalent to moves[i, i + l)
+    std::vector<std::vector<const std::vector<Move> *>> replacements(n);
+    auto worker = [&](size_t first)
+    {
+        for (size_t i = first; i < n; i += numThreads)
+            for (size_t l = 1; l <= window && i + l <= n; l++)
+                replacements[i].push_back(&optimalSequence(moves, i, i + l));
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < std::min<size_t>(numThreads, n); t++)
+        threads.emplace_back(worker, t);
+    worker(0);
+    for (auto &thread : threads)
+        thread.join();
+
+    // Cheapest way of splitting the first j moves into windows
+    std::vector<size_t> cost(n + 1, 0), split(n + 1, 0);
+    for (size_t j = 1; j <= n; j++)
+    {
+        cost[j] = cost[j - 1] + replacements[j - 1][0]->size();
+        split[j] = j - 1;
+        for (size_t l = 2; l <= window && l <= j; l++)
+        {
+            size_t candidate = cost[j - l] + replacements[j - l][l - 1]->size();
+            if (candidate < cost[j])
+            {
+                cost[j] = candidate;
+                split[j] = j - l;
+            }
+        }
+    }
+
+    std::vector<const std::vector<Move> *> segments;
+    for (size_t j = n; j > 0; j = split[j])
+        segments.push_back(replacements[split[j]][j - split[j] - 1]);
+    std::vector<Move> result;
+    result.reserve(cost[n]);
+    for (auto it = segments.rbegin(); it != segments.rend(); it++)
+        result.insert(result.end(), (*it)->begin(), (*it)->end());
+    return result;
+}
+
+OptimizationReport SolutionOptimizer::optimize(const std::vector<Move> &solution) const
+{
+    OptimizationReport report{solution, solution.size(), solution.size(), 0};
+    // Replaced windows can create new simplifications across their boundaries, so repeat until nothing changes
+    while (true)
+    {
+        auto shorter = optimizePass(report.solution);
+        report.passes++;
+        if (shorter.size() >= report.solution.size())
+            break;
+        report.solution = std::move(shorter);
+    }
+    report.optimizedLength = report.solution.size();
+    return report;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RubiksCube.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <iostream>
+
+struct Move
+{
+    Face face;
+    int turns; // 1 - clockwise, 2 - half turn, 3 - counterclockwise
+};
+
+bool operator==(const Move &lhs, const Move &rhs);
+
+std::ostream &operator<<(std::ostream &os, const Move &move);
+
+// Parses moves written in the standard notation, e.g. "F R2 U' D"
+std::vector<Move> parseMoves(const std::string &moves);
+
+std::string movesToString(const std::vector<Move> &moves);
+
+void applyMoves(RubiksCube &cube, const std::vector<Move> &moves);
+
+struct OptimizationReport
+{
+    std::vector<Move> solution;
+    size_t originalLength;
+    size_t optimizedLength;
+    int passes;
+};
+
+std::ostream &operator<<(std::ostream &os, const OptimizationReport &report);
+
+/*
+    Shortens solutions by sliding a window over the move sequence and replacing
+    every segment of at most maxWindow moves with the shortest sequence that has
+    the same effect on the cube. Shortest sequences are looked up in a table of
+    all positions within maxWindow moves of the solved cube, built once on
+    construction and shared by all later calls to optimize.
+*/
+class SolutionOptimizer
+{
+    int maxWindow;
+    unsigned int numThreads;
+    std::unordered_map<std::string, std::vector<Move>> optimalSequences;
+
+    void buildTable();
+    const std::vector<Move> &optimalSequence(const std::vector<Move> &moves, size_t begin, size_t end) const;
+    std::vector<Move> optimizePass(const std::vector<Move> &moves) const;
+
+public:
+    SolutionOptimizer(int maxWindow = 4, unsigned int numThreads = 0);
+
+    int getMaxWindow() const;
+
+    size_t tableSize() const;
+
+    // Never returns a solution longer than the given one
+    OptimizationReport optimize(const std::vector<Move> &solution) const;
+};
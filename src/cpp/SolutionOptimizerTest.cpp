@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "RubiksCube.h"
+#include "SolutionOptimizer.h"
+
+namespace
+{
+   const SolutionOptimizer &optimizer()
+   {
+      static const SolutionOptimizer optimizer(4, 4);
+      return optimizer;
+   }
+
+   RubiksCube afterMoves(const std::vector<Move> &moves)
+   {
+      RubiksCube cube;
+      applyMoves(cube, moves);
+      return cube;
+   }
+}
+
+TEST(SolutionOptimizer, parseMoves)
+{
+   auto moves = parseMoves("F R2 U' D");
+   std::vector<Move> expected = {{FRONT, 1}, {RIGHT, 2}, {TOP, 3}, {BOTTOM, 1}};
+   EXPECT_EQ(moves, expected);
+   EXPECT_EQ(movesToString(moves), "F R2 U' D");
+   EXPECT_THROW(parseMoves("F X"), std::invalid_argument);
+}
+
+TEST(SolutionOptimizer, tableSize)
+{
+   // Number of positions at distance 0, 1, 2, 3 and 4 in the half turn metric
+   EXPECT_EQ(optimizer().tableSize(), 1 + 18 + 243 + 3240 + 43239);
+}
+
+TEST(SolutionOptimizer, simplifies)
+{
+   EXPECT_EQ(optimizer().optimize(parseMoves("F F")).solution, parseMoves("F2"));
+   EXPECT_EQ(optimizer().optimize(parseMoves("R F F' R'")).solution, parseMoves(""));
+   EXPECT_EQ(optimizer().optimize(parseMoves("U R L R' L' U")).solution, parseMoves("U2"));
+   EXPECT_EQ(optimizer().optimize(parseMoves("F B F")).solution.size(), 2);
+   EXPECT_EQ(optimizer().optimize(parseMoves("")).solution, parseMoves(""));
+}
+
+TEST(SolutionOptimizer, randomizedOptimize)
+{
+   int numTests = 50;
+   srand(0);
+   for (int i = 0; i < numTests; i++)
+   {
+      std::vector<Move> solution;
+      for (int j = 0; j < 30; j++)
+         solution.push_back({Face(rand() % 6), rand() % 3 + 1});
+      auto report = optimizer().optimize(solution);
+      EXPECT_EQ(report.originalLength, solution.size());
+      EXPECT_EQ(report.optimizedLength, report.solution.size());
+      EXPECT_LE(report.optimizedLength, report.originalLength);
+      EXPECT_EQ(afterMoves(report.solution), afterMoves(solution));
+   }
+}